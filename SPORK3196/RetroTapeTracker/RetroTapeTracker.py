@@ -1,6 +1,11 @@
 import libjevois as jevois
 import cv2
 import numpy as np
+import sys
+
+# Native kernels of the sporkvision library, installed by the powercube project
+sys.path.append('/jevois/lib/spork')
+import sporkpy
 
 ## Tracks the center of a retro-reflective tape target
 #
@@ -15,18 +20,9 @@ import numpy as np
 # @ingroup modules
 class RetroTapeTracker:
     
-    def process(self, inframe, outframe):
-        kernel = np.ones((3,3),np.uint8)
-        
-        # Get the raw input image
-        raw = inframe.getCvBGR()
-        outImg = raw
-        
-        # Convert the image to HSV
-        hsv = cv2.cvtColor(raw, cv2.COLOR_BGR2HSV)
-        
+    def __init__(self):
         # Threshold the image with min and max HSV values
-        hsv_cooked = cv2.inRange(hsv, (0,0,230), (20,20,255))
+        self.kernel = sporkpy.BlobKernel((0,0,230), (20,20,255))
                                     # (70,0,170), (130,255,255) what we're doing
                                     #  50,0,180,   100,255,255
                                     #  70,0,120,   100,255,255
@@ -34,8 +30,16 @@ class RetroTapeTracker:
                                     #  70,50,200   100,220,255
                                     #  0,0,250     10,10,255
         
-        # Remove noise from the image (small patches of detection)
-        hsv_cooked = cv2.morphologyEx(hsv_cooked, cv2.MORPH_OPEN, kernel)
+        # Logging through the native queue, so the serial log never stalls a frame
+        self.edgelog = sporkpy.Logger("RetroTapeTracker edges")
+        self.avglog = sporkpy.Logger("RetroTapeTracker average")
+        self.nonelog = sporkpy.Logger("RetroTapeTracker none")
+    
+    def process(self, inframe, outframe):
+        # Threshold the camera's YUYV image in place and remove noise from it (small patches of detection),
+        # one erosion and one dilation, blobs of at least 10 pixels
+        blobs = self.kernel.process(inframe.get(), 1, 1, 10)
+        hsv_cooked = self.kernel.mask()
         
         # Find edges using Canny edge detection
         edgesImg = cv2.Canny(hsv_cooked, 1, 1) # Note: I have no idea what these number mean or do
@@ -45,8 +49,8 @@ class RetroTapeTracker:
             edges = cv2.HoughLinesP(edgesImg, 1, np.pi/180, 10, 10, 10)
             avgX = 0.0
             avgY = 0.0
-            text = "edges:" + str(len(edges))
-            jevois.LINFO(text)
+            text = "blobs:" + str(len(blobs)) + " edges:" + str(len(edges))
+            self.edgelog.info(text)
             for edge in edges:
                 for x1,y1,x2,y2 in edge:
                     avgX += (x1+x2)/2.0
@@ -55,34 +59,11 @@ class RetroTapeTracker:
                     #text += "\t(" + str(x1) + "," + str(y1) + ") (" + str(x2) + "," + str(y2) + ")"
             avgX = avgX / len(edges)
             avgY = avgY / len(edges)
-            outImg = cv2.line(raw, (int(avgX), 0), (int(avgX), 500), (0,0,0), 2)
-            outImg = cv2.line(outImg, (0, int(avgY)), (700, int(avgY)), (0,0,0), 2)
             text += "\t" + str(int(avgX))
-            jevois.LINFO(text)
+            self.avglog.info(text)
         except:
             # Do nothing!
-            jevois.LINFO("Nada")
+            self.nonelog.info("Nada")
         
         # Output the "cooked" image
-        minH = 1000.0
-        maxH = 0.0
-        minS = 1000.0
-        maxS = 0.0
-        minV = 1000.0
-        maxV = 0.0
-        for x in range(325,346):
-            h, s, v = hsv[267][x]
-            jevois.LINFO("H,S,V: " + str(h) + "  " + str(s) + "  " + str(v))
-            minH = min(minH, h)
-            maxH = max(maxH, h)
-            minS = min(minS, s)
-            maxS = max(maxS, s)
-            minV = min(minV, v)
-            maxV = max(maxV, v)
-        pixel_min = (minH, minS, minV)
-        pixel_max = (maxH, maxS, maxV)
-        
-        jevois.LINFO("PIXEL RANGE: " + str(pixel_min) + "  " + str(pixel_max))
-        
-        outImg = cv2.line(outImg, (325,267), (345,267), (127,127,127), 2)
         outframe.sendCv(hsv_cooked)
@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+# Stands in for the roboRIO, feeding recorded odometry to powercube over serial
+#
+# Usage: odom-replay.py odometry.csv [port [baud]]
+#
+# The CSV holds one sample per line: t_ms,yawrate,vel (roboRIO time in milliseconds, yaw rate in degrees per
+# second positive to the left, forward velocity in meters per second); lines that do not start with a number
+# are skipped. Samples are sent as "odom t yawrate vel" commands, paced by their timestamps, to the serial
+# port, or to stdout when no port is given, e.g. to pipe them into a jevois-daemon replaying the video that
+# was recorded together with the odometry. Start both together: the module maps the robot clock to its own
+# from the samples themselves.
+
+import sys
+import time
+
+
+def samples(path):
+    with open(path) as f:
+        for line in f:
+            fields = line.strip().split(',')
+            try:
+                yield int(float(fields[0])), float(fields[1]), float(fields[2])
+            except (ValueError, IndexError):
+                continue
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit('Usage: odom-replay.py odometry.csv [port [baud]]')
+
+    if len(sys.argv) > 2:
+        import serial
+        port = serial.Serial(sys.argv[2], int(sys.argv[3]) if len(sys.argv) > 3 else 115200)
+        write = lambda s: port.write(s.encode())
+    else:
+        write = lambda s: (sys.stdout.write(s), sys.stdout.flush())
+
+    start, first = time.monotonic(), None
+    for t, yawrate, vel in samples(sys.argv[1]):
+        if first is None:
+            first = t
+        delay = start + (t - first) / 1000.0 - time.monotonic()
+        if delay > 0:
+            time.sleep(delay)
+        write('odom %d %.3f %.3f\n' % (t, yawrate, vel))
+
+
+if __name__ == '__main__':
+    main()
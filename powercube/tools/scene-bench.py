@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# Sweeps synthetic scene complexity and reports the latency and accuracy of the cube pipeline
+#
+# Usage: scene-bench.py [--bin DIR] [--frames N] [--cubes 0-10] [--clutter 0,10,30] [--scales 1,2]
+#                       [--noise SIGMA] [--plot chart.png]
+#
+# For every cube count and clutter level, scene-synth renders a recording, and recording-replay runs it
+# through the pipeline at every processing scale (1 is full resolution, 2 the half resolution of the thermal
+# governor). One CSV line is printed per run:
+#
+#     scale,cubes,clutter,frames,ms_mean,ms_p95,fps,recall,precision,range_err
+#
+# Latency is the processing time per frame. Accuracy compares the confirmed cubes to the ground truth of
+# the cube faces at least half visible, skipping the first frames of each scene while the tracks confirm:
+# a cube matches the nearest face center within a twelfth of the image width; range_err is the mean
+# relative range error of the matches. With --plot, the latency and recall are charted with matplotlib.
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+SCENE_FRAMES = 30       # As in scene-synth
+WARMUP = 5              # Frames of a scene before its cubes are confirmed
+
+
+def parse_frames(output):
+    """Pairs of (truth, (ms, cubes)) from the recording-replay output."""
+    truth = None
+    for line in output.splitlines():
+        tok = line.split()
+        if len(tok) > 3 and tok[2] == 'TRUTH':
+            n = int(tok[3])
+            f = [float(v) for v in tok[4:4 + 14 * n]]
+            truth = [(f[i], f[i + 1], f[i + 2], f[i + 5]) for i in range(0, 14 * n, 14)]
+        elif len(tok) > 2 and truth is not None:
+            cubes = []
+            if len(tok) > 4 and tok[3] == 'CUBES':
+                n = int(tok[4])
+                f = tok[5:5 + 8 * n]
+                cubes = [(float(f[i + 1]), float(f[i + 2]), float(f[i + 5])) for i in range(0, 8 * n, 8)]
+            yield truth, (float(tok[2]), cubes)
+            truth = None
+
+
+def score(frames, width):
+    radius = width / 12.0
+    times, expected, detected, matched, range_err = [], 0, 0, 0, []
+    for i, (truth, (ms, cubes)) in enumerate(frames):
+        times.append(ms)
+        if i % SCENE_FRAMES < WARMUP:
+            continue
+
+        faces = [t for t in truth if t[3] >= 0.5]
+        expected += len(faces)
+        detected += len(cubes)
+        for x, y, rng in cubes:
+            best = min(faces, key=lambda t: (t[0] - x) ** 2 + (t[1] - y) ** 2, default=None)
+            if best is not None and (best[0] - x) ** 2 + (best[1] - y) ** 2 <= radius ** 2:
+                faces.remove(best)
+                matched += 1
+                if rng > 0:
+                    range_err.append(abs(rng - best[2]) / best[2])
+
+    times.sort()
+    mean = sum(times) / len(times) if times else 0.0
+    p95 = times[min(len(times) - 1, int(0.95 * len(times)))] if times else 0.0
+    return {
+        'frames': len(times),
+        'ms_mean': mean,
+        'ms_p95': p95,
+        'fps': 1000.0 / mean if mean > 0 else 0.0,
+        'recall': matched / expected if expected else 1.0,
+        'precision': matched / detected if detected else 1.0,
+        'range_err': sum(range_err) / len(range_err) if range_err else 0.0,
+    }
+
+
+def plot(rows, path):
+    import matplotlib
+    matplotlib.use('Agg')
+    import matplotlib.pyplot as plt
+
+    fig, (lat, rec) = plt.subplots(1, 2, figsize=(12, 5))
+    for key in sorted({(r['scale'], r['clutter']) for r in rows}):
+        pts = sorted((r['cubes'], r['ms_mean'], r['recall']) for r in rows if (r['scale'], r['clutter']) == key)
+        label = 'scale %d, clutter %d' % key
+        lat.plot([p[0] for p in pts], [p[1] for p in pts], marker='o', label=label)
+        rec.plot([p[0] for p in pts], [p[2] for p in pts], marker='o', label=label)
+    lat.set_xlabel('cubes')
+    lat.set_ylabel('ms per frame')
+    rec.set_xlabel('cubes')
+    rec.set_ylabel('recall')
+    rec.set_ylim(0, 1.05)
+    lat.legend()
+    fig.tight_layout()
+    fig.savefig(path)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Benchmark the cube pipeline over synthetic scenes')
+    ap.add_argument('--bin', default='.', help='directory of scene-synth and recording-replay')
+    ap.add_argument('--frames', type=int, default=300)
+    ap.add_argument('--cubes', default='0-10', help='range of cube counts, e.g. 0-10')
+    ap.add_argument('--clutter', default='0,10,30', help='clutter levels')
+    ap.add_argument('--scales', default='1,2', help='processing scales')
+    ap.add_argument('--noise', type=float, default=3.0)
+    ap.add_argument('--width', type=int, default=320)
+    ap.add_argument('--height', type=int, default=240)
+    ap.add_argument('--seed', type=int, default=1)
+    ap.add_argument('--plot', help='chart latency and recall into this image')
+    args = ap.parse_args()
+
+    lo, _, hi = args.cubes.partition('-')
+    cubes = range(int(lo), int(hi or lo) + 1)
+    clutters = [int(c) for c in args.clutter.split(',')]
+    scales = [int(s) for s in args.scales.split(',')]
+    synth = os.path.join(args.bin, 'scene-synth')
+    replay = os.path.join(args.bin, 'recording-replay')
+
+    keys = ['frames', 'ms_mean', 'ms_p95', 'fps', 'recall', 'precision', 'range_err']
+    print('scale,cubes,clutter,' + ','.join(keys))
+    rows = []
+    with tempfile.TemporaryDirectory() as tmp:
+        for clutter in clutters:
+            for n in cubes:
+                rec = os.path.join(tmp, 'scene-%d-%d.spr' % (n, clutter))
+                subprocess.run([synth, rec, str(args.frames), str(n), str(n), str(clutter), str(args.noise),
+                                str(args.seed), str(args.width), str(args.height)], check=True)
+                for scale in scales:
+                    out = subprocess.run([replay, rec, '0', str(args.frames), str(scale)], check=True,
+                                         stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, universal_newlines=True)
+                    r = score(list(parse_frames(out.stdout)), args.width)
+                    r.update(scale=scale, cubes=n, clutter=clutter)
+                    rows.append(r)
+                    print('%d,%d,%d,%d,%.3f,%.3f,%.1f,%.3f,%.3f,%.3f' % ((scale, n, clutter) + tuple(r[k] for k in keys)))
+                    sys.stdout.flush()
+
+    if args.plot:
+        plot(rows, args.plot)
+
+
+if __name__ == '__main__':
+    main()